@@ -0,0 +1,306 @@
+// Generador de escenarios de carga para medir los motores en sus peores casos.
+// Cada escenario tiene un nombre, un parámetro opcional y una semilla; con la misma semilla
+// se generan exactamente los mismos círculos en cualquier motor.
+//
+// Uso desde la línea de comando (en cualquier posición, junto a los argumentos habituales):
+//   --escenario <nombre>[:parámetro]   --semilla <n>
+//
+// Escenarios disponibles:
+//   uniforme          dispersión aleatoria uniforme, como Circle::randomCircle pero sin círculos quietos (dx = dy = 0)
+//   cumulos[:k]       k cúmulos densos con distribución normal alrededor de centros aleatorios (k = 4)
+//   choque[:v]        disco compacto en el centro con todos los círculos solapados y velocidad v hacia el centro (0 < v <= 1, v = 1)
+//   radios[:max]      radios entre 5 y max con cola pesada: muchos pequeños y unos pocos enormes (max = 120)
+//   paredes[:p]       círculos incrustados p píxeles en los bordes, rebotando en cada fotograma (0 < p < 5, p = 2).
+//                     ScreenSaver_Secuencial rebota con el centro (x <= 0), no con el borde del círculo,
+//                     así que allí estos círculos no quedan fijos: solo arrancan pegados a la pared.
+#ifndef ESCENARIOS_H
+#define ESCENARIOS_H
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Configuración del escenario elegido en la línea de comando
+struct SceneConfig
+{
+    std::string name; // Vacío si no se pidió ningún escenario
+    double param = 0; // 0 significa usar el valor por defecto del escenario
+    unsigned seed = 1;
+
+    bool enabled() const { return !name.empty(); }
+};
+
+// Extraer `--escenario` y `--semilla` de argv, dejando solo los argumentos posicionales de cada motor
+inline bool parseSceneArgs(int &argc, char *argv[], SceneConfig &config)
+{
+    static const char *names[] = {"uniforme", "cumulos", "choque", "radios", "paredes"};
+
+    int kept = 1;
+    bool requested = false; // Distingue `--escenario :3` (nombre vacío) de no pedir ningún escenario
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        std::string key, value;
+        size_t eq = arg.find('=');
+        if (arg.rfind("--", 0) == 0 && eq != std::string::npos)
+        {
+            key = arg.substr(0, eq);
+            value = arg.substr(eq + 1);
+        }
+        else if (arg == "--escenario" || arg == "--semilla")
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Error: falta el valor de " << arg << "." << std::endl;
+                return false;
+            }
+            key = arg;
+            value = argv[++i];
+        }
+        else
+        {
+            argv[kept++] = argv[i];
+            continue;
+        }
+
+        try
+        {
+            if (key == "--escenario")
+            {
+                size_t colon = value.find(':');
+                config.name = value.substr(0, colon);
+                config.param = 0;
+                requested = true;
+                if (colon != std::string::npos)
+                {
+                    std::string param = value.substr(colon + 1);
+                    size_t pos;
+                    config.param = std::stod(param, &pos);
+                    if (pos != param.size())
+                    {
+                        throw std::invalid_argument("escenario");
+                    }
+                }
+            }
+            else if (key == "--semilla")
+            {
+                // stoul aceptaría "-1" y lo convertiría en 4294967295; se rechaza igual que un número inválido
+                size_t pos;
+                long long seed = std::stoll(value, &pos);
+                if (pos != value.size())
+                {
+                    throw std::invalid_argument("semilla");
+                }
+                if (seed < 0 || seed > UINT_MAX)
+                {
+                    throw std::out_of_range("semilla");
+                }
+                config.seed = seed;
+            }
+            else
+            {
+                argv[kept++] = argv[i];
+            }
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Error: el valor de " << key << " no es un número válido." << std::endl;
+            return false;
+        }
+    }
+    argc = kept;
+    argv[argc] = nullptr;
+
+    if (requested && std::find_if(std::begin(names), std::end(names), [&](const char *n)
+                                         { return config.name == n; }) == std::end(names))
+    {
+        std::cerr << "Error: escenario desconocido '" << config.name << "'. Opciones:";
+        for (const char *n : names)
+        {
+            std::cerr << " " << n;
+        }
+        std::cerr << std::endl;
+        return false;
+    }
+    if (config.param < 0)
+    {
+        std::cerr << "Error: el parámetro del escenario debe ser positivo." << std::endl;
+        return false;
+    }
+    if (config.name == "cumulos" && config.param > 0 && config.param < 1)
+    {
+        std::cerr << "Error: cumulos necesita al menos 1 cúmulo." << std::endl;
+        return false;
+    }
+    if (config.name == "radios" && config.param > 0 && config.param < 5)
+    {
+        std::cerr << "Error: el radio máximo de radios no puede ser menor que 5." << std::endl;
+        return false;
+    }
+    // Con más de 1 px por fotograma los círculos atraviesan el disco sin llegar a solaparse
+    if (config.name == "choque" && config.param > 1)
+    {
+        std::cerr << "Error: la velocidad de choque no puede ser mayor que 1." << std::endl;
+        return false;
+    }
+    // El radio mínimo es 5: con p >= 5 el centro quedaría sobre la pared o fuera del lienzo
+    if (config.name == "paredes" && config.param >= 5)
+    {
+        std::cerr << "Error: la profundidad de paredes debe ser menor que 5." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Radio máximo que puede generar el escenario; los motores lo usan para dimensionar estructuras como el halo
+inline int sceneMaxRadius(const SceneConfig &config, int canvasWidth, int canvasHeight)
+{
+    if (config.name == "radios")
+    {
+        int limit = std::min(canvasWidth, canvasHeight) / 2 - 1;
+        return std::min(limit, config.param > 0 ? int(config.param) : 120);
+    }
+    return 24;
+}
+
+// Llenar `circles[0..n)` según el escenario. Solo usa los campos comunes a todos los motores
+// (x, y, dx, dy, radius, color), por eso sirve para cualquier versión de Circle.
+template <typename C>
+void generateScene(C *circles, int n, int canvasWidth, int canvasHeight, const SceneConfig &config)
+{
+    // Generador propio para no depender del estado de rand() ni del orden de los hilos
+    std::mt19937 rng(config.seed);
+    auto uniform = [&](float a, float b)
+    { return std::uniform_real_distribution<float>(a, b)(rng); };
+    auto randomRadius = [&]()
+    { return std::uniform_int_distribution<int>(5, 24)(rng); };
+    auto randomColor = [&]()
+    {
+        std::uniform_int_distribution<int> channel(0, 255);
+        return SDL_Color{Uint8(channel(rng)), Uint8(channel(rng)), Uint8(channel(rng)), 255};
+    };
+    // Múltiplos de 0.2 en [-1.0, 0.8] como randomCircle, pero repitiendo el sorteo si sale (0, 0)
+    auto randomVelocity = [&](C &c)
+    {
+        std::uniform_int_distribution<int> step(-5, 4);
+        do
+        {
+            c.dx = step(rng) / 5.0;
+            c.dy = step(rng) / 5.0;
+        } while (c.dx == 0 && c.dy == 0);
+    };
+    const float maxRadius = std::min(canvasWidth, canvasHeight) / 2.0f - 1;
+    const float centerX = canvasWidth / 2.0f;
+    const float centerY = canvasHeight / 2.0f;
+
+    if (config.name == "cumulos")
+    {
+        int k = config.param > 0 ? int(config.param) : 4;
+        std::vector<std::pair<float, float>> centers(k);
+        for (auto &center : centers)
+        {
+            center = {uniform(0, canvasWidth), uniform(0, canvasHeight)};
+        }
+        std::normal_distribution<float> spread(0, 30);
+        for (int i = 0; i < n; i++)
+        {
+            C &c = circles[i];
+            c.x = std::clamp(centers[i % k].first + spread(rng), 0.0f, canvasWidth - 1.0f);
+            c.y = std::clamp(centers[i % k].second + spread(rng), 0.0f, canvasHeight - 1.0f);
+            randomVelocity(c);
+            c.radius = randomRadius();
+            c.color = randomColor();
+        }
+    }
+    else if (config.name == "choque")
+    {
+        // Disco con densidad ~2: cada círculo se solapa con varios vecinos desde el primer fotograma
+        float speed = config.param > 0 ? config.param : 1;
+        float discRadius = std::min(maxRadius, 14.0f * std::sqrt(n / 2.0f));
+        for (int i = 0; i < n; i++)
+        {
+            C &c = circles[i];
+            float angle = uniform(0, 2 * M_PI);
+            float distance = discRadius * std::sqrt(uniform(0, 1));
+            c.x = centerX + distance * std::cos(angle);
+            c.y = centerY + distance * std::sin(angle);
+            c.dx = -speed * std::cos(angle);
+            c.dy = -speed * std::sin(angle);
+            c.radius = randomRadius();
+            c.color = randomColor();
+        }
+    }
+    else if (config.name == "radios")
+    {
+        int maxR = sceneMaxRadius(config, canvasWidth, canvasHeight);
+        for (int i = 0; i < n; i++)
+        {
+            C &c = circles[i];
+            c.x = uniform(0, canvasWidth);
+            c.y = uniform(0, canvasHeight);
+            randomVelocity(c);
+            c.radius = 5 + int((maxR - 5) * std::pow(uniform(0, 1), 4));
+            c.color = randomColor();
+        }
+    }
+    else if (config.name == "paredes")
+    {
+        // Un círculo incrustado en la pared invierte su velocidad cada fotograma sin llegar a salir
+        float depth = config.param > 0 ? config.param : 2;
+        std::uniform_int_distribution<int> wall(0, 3);
+        for (int i = 0; i < n; i++)
+        {
+            C &c = circles[i];
+            c.radius = randomRadius();
+            c.color = randomColor();
+            float inset = c.radius - depth;
+            switch (wall(rng))
+            {
+            case 0:
+                c.x = inset;
+                c.y = uniform(0, canvasHeight);
+                c.dx = -1;
+                c.dy = uniform(-0.2f, 0.2f);
+                break;
+            case 1:
+                c.x = canvasWidth - inset;
+                c.y = uniform(0, canvasHeight);
+                c.dx = 1;
+                c.dy = uniform(-0.2f, 0.2f);
+                break;
+            case 2:
+                c.x = uniform(0, canvasWidth);
+                c.y = inset;
+                c.dx = uniform(-0.2f, 0.2f);
+                c.dy = -1;
+                break;
+            default:
+                c.x = uniform(0, canvasWidth);
+                c.y = canvasHeight - inset;
+                c.dx = uniform(-0.2f, 0.2f);
+                c.dy = 1;
+                break;
+            }
+        }
+    }
+    else
+    {
+        for (int i = 0; i < n; i++)
+        {
+            C &c = circles[i];
+            c.x = std::uniform_int_distribution<int>(0, canvasWidth - 1)(rng);
+            c.y = std::uniform_int_distribution<int>(0, canvasHeight - 1)(rng);
+            randomVelocity(c);
+            c.radius = randomRadius();
+            c.color = randomColor();
+        }
+    }
+}
+
+#endif
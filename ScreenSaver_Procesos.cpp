@@ -0,0 +1,967 @@
+// Versión multiproceso: el lienzo se divide en franjas horizontales, un proceso trabajador por franja.
+// Cada trabajador simula y rasteriza los círculos que le pertenecen e intercambia con sus vecinos
+// los círculos de borde (halo) y los que migran de franja a través de memoria compartida POSIX.
+// Las colisiones de cada franja usan una fase amplia sweep-and-prune sobre los círculos propios y los halos.
+// El proceso principal actúa como compositor: solo presenta el framebuffer compartido con SDL.
+//
+// Compilar: g++ -O2 ScreenSaver_Procesos.cpp -o ScreenSaver_Procesos -lSDL2 -pthread -lrt
+// Uso:      ./ScreenSaver_Procesos [N] [radio] [franjas] [ancho] [alto] [--escenario nombre[:parámetro]] [--semilla n]
+//           Un radio de 0 o -1 conserva los radios aleatorios (o los del escenario).
+#include <SDL2/SDL.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <pthread.h>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include "Escenarios.h"
+
+// Estructura para representar una partícula
+struct Particle
+{
+    float x, y;
+    float dx, dy;
+    int lifetime;
+    SDL_Color color;
+
+    // Mover la partícula
+    void move()
+    {
+        x += dx;
+        y += dy;
+        lifetime--;
+    }
+};
+
+// Bloque de elementos en memoria compartida: un contador seguido de la capacidad reservada
+template <typename T>
+struct SharedBuffer
+{
+    int count;
+
+    T *data() { return reinterpret_cast<T *>(this + 1); }
+    const T *data() const { return reinterpret_cast<const T *>(this + 1); }
+};
+
+struct Circle;
+using CircleBuffer = SharedBuffer<Circle>;
+using ParticleBuffer = SharedBuffer<Particle>;
+
+// Estructura para representar un círculo
+struct Circle
+{
+    float x, y;
+    float dx, dy;
+    int radius;
+    SDL_Color color;
+    int id; // Identificador global estable: fija el orden de dibujo igual en todas las franjas
+
+    // Crear partículas en la posición del círculo cuando colisiona
+    void spawnParticles(std::vector<Particle> &particles) const
+    {
+        const int numParticles = 30;
+        for (int i = 0; i < numParticles; i++)
+        {
+            Particle p;
+            p.x = x;
+            p.y = y;
+            float angle = (2 * M_PI / numParticles) * i;
+            p.dx = 0.5 * cos(angle);
+            p.dy = 0.5 * sin(angle);
+            p.lifetime = 30 + (rand() % 20);
+            p.color = {Uint8(rand() % 256), Uint8(rand() % 256), Uint8(rand() % 256), 255};
+            particles.push_back(p);
+        }
+    }
+
+    // Mover el círculo y rebotar en los bordes
+    void move(int canvasWidth, int canvasHeight)
+    {
+        x += dx;
+        y += dy;
+
+        if (x - radius <= 0 || x + radius >= canvasWidth)
+        {
+            dx = -dx;
+        }
+        if (y - radius <= 0 || y + radius >= canvasHeight)
+        {
+            dy = -dy;
+        }
+    }
+
+    // Prueba fina contra otro círculo propio; si se solapan, separa a ambos y devuelve true
+    bool collide(Circle &other)
+    {
+        float distance = sqrt(pow(x - other.x, 2) + pow(y - other.y, 2));
+        if (distance > (radius + other.radius))
+        {
+            return false;
+        }
+
+        // Mover los círculos fuera del área de colisión
+        float overlap = radius + other.radius - distance;
+        float angle = atan2(y - other.y, x - other.x);
+        x += overlap * cos(angle) / 2;
+        y += overlap * sin(angle) / 2;
+        other.x -= overlap * cos(angle) / 2;
+        other.y -= overlap * sin(angle) / 2;
+        return true;
+    }
+
+    // Prueba fina contra un círculo del halo. Pertenece a otro proceso: solo se calcula la mitad de la
+    // corrección que le toca a este círculo, y el vecino calcula la otra mitad con las mismas posiciones.
+    bool haloCorrection(const Circle &other, float &cx, float &cy) const
+    {
+        float distance = sqrt(pow(x - other.x, 2) + pow(y - other.y, 2));
+        if (distance > (radius + other.radius))
+        {
+            return false;
+        }
+
+        float overlap = radius + other.radius - distance;
+        float angle = atan2(y - other.y, x - other.x);
+        cx += overlap * cos(angle) / 2;
+        cy += overlap * sin(angle) / 2;
+        return true;
+    }
+
+    // Revertir la dirección de movimiento del círculo
+    void bounce()
+    {
+        dx = -dx;
+        dy = -dy;
+    }
+
+    // Método estático para generar un círculo aleatorio
+    static Circle randomCircle(int canvasWidth, int canvasHeight)
+    {
+        Circle c;
+        c.x = rand() % canvasWidth;
+        c.y = rand() % canvasHeight;
+        c.dx = (rand() % 10 - 5) / 5.0;
+        c.dy = (rand() % 10 - 5) / 5.0;
+        c.radius = rand() % 20 + 5;
+        c.color = {Uint8(rand() % 256), Uint8(rand() % 256), Uint8(rand() % 256), 255};
+        return c;
+    }
+};
+
+// Extremo izquierdo del intervalo en x de un círculo, la clave de orden del sweep-and-prune
+static inline float minX(const Circle &c)
+{
+    return c.x - c.radius;
+}
+
+// Fase amplia sweep-and-prune de una franja. En lugar de un índice aparte, los círculos propios se
+// mantienen ordenados físicamente por x - radio: quitar migrantes conserva el orden, los que llegan
+// se colocan por inserción y los halos salen ya ordenados porque son subsecuencias del orden propio.
+class SweepAndPrune
+{
+public:
+    // Ordenar los círculos propios: std::sort la primera vez, inserción (casi O(N)) en los fotogramas siguientes
+    void sort(std::vector<Circle> &circles)
+    {
+        if (!sorted)
+        {
+            std::sort(circles.begin(), circles.end(), [](const Circle &a, const Circle &b)
+                      { return minX(a) < minX(b); });
+            sorted = true;
+            return;
+        }
+        for (size_t i = 1; i < circles.size(); i++)
+        {
+            Circle key = circles[i];
+            size_t j = i;
+            while (j > 0 && minX(circles[j - 1]) > minX(key))
+            {
+                circles[j] = circles[j - 1];
+                j--;
+            }
+            circles[j] = key;
+        }
+    }
+
+    // Calcular los pares candidatos entre círculos propios y entre cada círculo propio y cada halo.
+    // Los círculos propios y los halos deben estar ordenados por x - radio.
+    void update(const std::vector<Circle> &circles, const std::vector<const CircleBuffer *> &halos)
+    {
+        ownedPairs.clear();
+        for (size_t i = 0; i < circles.size(); i++)
+        {
+            float maxX = circles[i].x + circles[i].radius;
+            for (size_t j = i + 1; j < circles.size() && minX(circles[j]) <= maxX; j++)
+            {
+                if (overlapY(circles[i], circles[j]))
+                {
+                    ownedPairs.emplace_back(i, j);
+                }
+            }
+        }
+
+        haloPairs.resize(halos.size());
+        for (size_t h = 0; h < halos.size(); h++)
+        {
+            sweepHalo(circles, halos[h]->data(), halos[h]->count, haloPairs[h]);
+        }
+    }
+
+    std::vector<std::pair<int, int>> ownedPairs;
+    std::vector<std::vector<std::pair<int, int>>> haloPairs; // (círculo propio, círculo del halo) por halo
+
+private:
+    static bool overlapY(const Circle &a, const Circle &b)
+    {
+        return std::abs(a.y - b.y) <= a.radius + b.radius;
+    }
+
+    // Barrido entre dos listas ordenadas. Cada par se encuentra una sola vez, desde el intervalo que
+    // empieza primero (en caso de empate, desde el círculo propio).
+    static void sweepHalo(const std::vector<Circle> &circles, const Circle *others, int count,
+                          std::vector<std::pair<int, int>> &pairs)
+    {
+        pairs.clear();
+        int n = circles.size();
+        int first = 0;
+        for (int i = 0; i < n; i++)
+        {
+            float maxX = circles[i].x + circles[i].radius;
+            while (first < count && minX(others[first]) < minX(circles[i]))
+            {
+                first++;
+            }
+            for (int j = first; j < count && minX(others[j]) <= maxX; j++)
+            {
+                if (overlapY(circles[i], others[j]))
+                {
+                    pairs.emplace_back(i, j);
+                }
+            }
+        }
+        first = 0;
+        for (int j = 0; j < count; j++)
+        {
+            float maxX = others[j].x + others[j].radius;
+            while (first < n && minX(circles[first]) <= minX(others[j]))
+            {
+                first++;
+            }
+            for (int i = first; i < n && minX(circles[i]) <= maxX; i++)
+            {
+                if (overlapY(circles[i], others[j]))
+                {
+                    pairs.emplace_back(i, j);
+                }
+            }
+        }
+    }
+
+    bool sorted = false;
+};
+
+// Tipos de buzón que cada franja publica hacia sus vecinas
+enum Mailbox
+{
+    HALO_UP,
+    HALO_DOWN,
+    MIGRANTS_UP,
+    MIGRANTS_DOWN,
+    NUM_MAILBOXES
+};
+
+// Buzones de partículas que cruzan el borde de la franja
+enum ParticleMailbox
+{
+    PARTICLES_UP,
+    PARTICLES_DOWN,
+    NUM_PARTICLE_MAILBOXES
+};
+
+// Cabecera del segmento compartido. La barrera sincroniza a los trabajadores y al compositor.
+struct SharedHeader
+{
+    pthread_barrier_t barrier;
+    volatile int running;
+};
+
+// Vista del segmento de memoria compartida: cabecera, buzones por franja y framebuffer ARGB
+class SharedMemory
+{
+public:
+    SharedMemory(int numStrips, int capacity, int particleCapacity, int canvasWidth, int canvasHeight)
+        : capacity(capacity), particleCapacity(particleCapacity), canvasWidth(canvasWidth)
+    {
+        // Alinear cada buzón y el framebuffer a 64 bytes para no compartir líneas de caché entre franjas
+        bufferStride = align(sizeof(CircleBuffer) + size_t(capacity) * sizeof(Circle));
+        particleStride = align(sizeof(ParticleBuffer) + size_t(particleCapacity) * sizeof(Particle));
+        mailboxOffset = align(sizeof(SharedHeader));
+        particleOffset = mailboxOffset + bufferStride * numStrips * NUM_MAILBOXES;
+        framebufferOffset = particleOffset + particleStride * numStrips * NUM_PARTICLE_MAILBOXES;
+        size = framebufferOffset + size_t(canvasWidth) * canvasHeight * sizeof(Uint32);
+    }
+
+    const int capacity;
+    const int particleCapacity;
+
+    // Crear el segmento; los buzones se reservan con capacidad N pero tmpfs solo asigna las páginas tocadas
+    bool create()
+    {
+        std::string name = "/screensaver_" + std::to_string(getpid());
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+        {
+            return false;
+        }
+        // El segmento se hereda en fork() a través del mapeo; el nombre ya no es necesario
+        shm_unlink(name.c_str());
+        if (ftruncate(fd, size) != 0)
+        {
+            close(fd);
+            return false;
+        }
+        void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (ptr == MAP_FAILED)
+        {
+            return false;
+        }
+        base = static_cast<char *>(ptr);
+        return true;
+    }
+
+    void destroy()
+    {
+        if (base)
+        {
+            munmap(base, size);
+            base = nullptr;
+        }
+    }
+
+    SharedHeader *header() { return reinterpret_cast<SharedHeader *>(base); }
+
+    CircleBuffer *mailbox(int strip, Mailbox kind)
+    {
+        return reinterpret_cast<CircleBuffer *>(base + mailboxOffset + bufferStride * (strip * NUM_MAILBOXES + kind));
+    }
+
+    ParticleBuffer *particleMailbox(int strip, ParticleMailbox kind)
+    {
+        return reinterpret_cast<ParticleBuffer *>(base + particleOffset + particleStride * (strip * NUM_PARTICLE_MAILBOXES + kind));
+    }
+
+    Uint32 *row(int y) { return reinterpret_cast<Uint32 *>(base + framebufferOffset) + size_t(y) * canvasWidth; }
+
+private:
+    static size_t align(size_t bytes) { return (bytes + 63) & ~size_t(63); }
+
+    int canvasWidth;
+    size_t bufferStride = 0;
+    size_t particleStride = 0;
+    size_t mailboxOffset = 0;
+    size_t particleOffset = 0;
+    size_t framebufferOffset = 0;
+    size_t size = 0;
+    char *base = nullptr;
+};
+
+// Empaquetar un color SDL en formato ARGB8888
+static inline Uint32 packColor(const SDL_Color &c)
+{
+    return (Uint32(c.a) << 24) | (Uint32(c.r) << 16) | (Uint32(c.g) << 8) | Uint32(c.b);
+}
+
+// Dibujar un círculo en el framebuffer, recortado a las filas [top, bottom) de la franja
+static void drawCircle(SharedMemory &shm, const Circle &circle, int top, int bottom, int canvasWidth)
+{
+    Uint32 color = packColor(circle.color);
+    for (int h = -circle.radius; h < circle.radius; h++)
+    {
+        int py = circle.y + h;
+        if (py < top || py >= bottom)
+        {
+            continue;
+        }
+        Uint32 *row = shm.row(py);
+        for (int w = -circle.radius; w < circle.radius; w++)
+        {
+            int px = circle.x + w;
+            if (px >= 0 && px < canvasWidth && w * w + h * h <= circle.radius * circle.radius)
+            {
+                row[px] = color;
+            }
+        }
+    }
+}
+
+// Copiar una lista a un buzón compartido, sin pasar de su capacidad
+template <typename T>
+static void publish(SharedBuffer<T> *buffer, const std::vector<T> &list, int capacity)
+{
+    int count = std::min<size_t>(list.size(), capacity);
+    std::copy(list.begin(), list.begin() + count, buffer->data());
+    buffer->count = count;
+}
+
+// Añadir al final de `list` lo que un vecino dejó en su buzón
+template <typename T>
+static void receive(std::vector<T> &list, const SharedBuffer<T> *buffer)
+{
+    list.insert(list.end(), buffer->data(), buffer->data() + buffer->count);
+}
+
+// Bucle de un proceso trabajador que simula la franja [top, bottom)
+static void runWorker(SharedMemory &shm, int strip, int numStrips, int top, int bottom,
+                      int canvasWidth, int canvasHeight, int maxRadius, std::vector<Circle> circles)
+{
+    SharedHeader *header = shm.header();
+    std::vector<Particle> particles;
+    std::vector<Circle> outUp, outDown;
+    std::vector<Particle> particlesUp, particlesDown;
+    SweepAndPrune broadPhase;
+    std::vector<char> collided;
+    std::vector<const Circle *> drawList;
+    std::vector<std::pair<float, float>> corrections;
+
+    // Halos que envían las franjas vecinas hacia esta franja, y si vienen de la franja de abajo
+    std::vector<const CircleBuffer *> halos;
+    std::vector<char> haloFromBelow;
+    if (strip > 0)
+    {
+        halos.push_back(shm.mailbox(strip - 1, HALO_DOWN));
+        haloFromBelow.push_back(0);
+    }
+    if (strip < numStrips - 1)
+    {
+        halos.push_back(shm.mailbox(strip + 1, HALO_UP));
+        haloFromBelow.push_back(1);
+    }
+
+    // Un círculo es relevante para el vecino si puede dibujarse en su franja o chocar con alguno de sus círculos
+    const int haloMargin = maxRadius + 2;
+
+    double totalTime = 0;
+    int iterations = 0;
+
+    while (true)
+    {
+        // Fase 1: mover los círculos propios y publicar los de borde con esas posiciones, ordenados para
+        // el barrido del vecino. Tras la barrera todas las franjas dibujan y prueban colisiones sobre
+        // la misma instantánea, así que un choque entre franjas se detecta igual a ambos lados.
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (auto &circle : circles)
+        {
+            circle.move(canvasWidth, canvasHeight);
+        }
+        broadPhase.sort(circles);
+        outUp.clear();
+        outDown.clear();
+        for (const Circle &circle : circles)
+        {
+            if (strip > 0 && circle.y - circle.radius - haloMargin < top)
+            {
+                outUp.push_back(circle);
+            }
+            if (strip < numStrips - 1 && circle.y + circle.radius + haloMargin >= bottom)
+            {
+                outDown.push_back(circle);
+            }
+        }
+        publish(shm.mailbox(strip, HALO_UP), outUp, shm.capacity);
+        publish(shm.mailbox(strip, HALO_DOWN), outDown, shm.capacity);
+
+        auto published = std::chrono::high_resolution_clock::now();
+        pthread_barrier_wait(&header->barrier);
+        if (!header->running)
+        {
+            break;
+        }
+
+        // Fase 2: rasterizar la instantánea y resolver colisiones
+        totalTime += std::chrono::duration_cast<std::chrono::microseconds>(published - start).count();
+        start = std::chrono::high_resolution_clock::now();
+
+        for (int y = top; y < bottom; y++)
+        {
+            std::fill(shm.row(y), shm.row(y) + canvasWidth, packColor({0, 0, 0, 255}));
+        }
+
+        // Dibujar propios y halos en un único orden global por id; si cada franja dibujara primero los
+        // suyos, dos círculos solapados sobre el borde se taparían al revés a cada lado de la costura
+        drawList.clear();
+        for (const Circle &circle : circles)
+        {
+            drawList.push_back(&circle);
+        }
+        for (const CircleBuffer *halo : halos)
+        {
+            for (int i = 0; i < halo->count; i++)
+            {
+                drawList.push_back(&halo->data()[i]);
+            }
+        }
+        std::sort(drawList.begin(), drawList.end(), [](const Circle *a, const Circle *b)
+                  { return a->id < b->id; });
+        for (const Circle *circle : drawList)
+        {
+            drawCircle(shm, *circle, top, bottom, canvasWidth);
+        }
+        // Prueba fina solo sobre los pares candidatos, una vez por par; cada círculo rebota como mucho
+        // una vez por fotograma y cada colisión crea una sola explosión de partículas
+        broadPhase.update(circles, halos);
+        collided.assign(circles.size(), 0);
+
+        // Primero los halos, con las posiciones de la instantánea: las correcciones se acumulan y se
+        // aplican al final para que el vecino, que hace la misma prueba, vea exactamente las mismas
+        // distancias. La explosión de un choque entre franjas la crea solo la franja de arriba.
+        corrections.assign(circles.size(), {0.0f, 0.0f});
+        for (size_t h = 0; h < halos.size(); h++)
+        {
+            const Circle *others = halos[h]->data();
+            for (const auto &pair : broadPhase.haloPairs[h])
+            {
+                int a = pair.first;
+                if (!circles[a].haloCorrection(others[pair.second], corrections[a].first, corrections[a].second))
+                {
+                    continue;
+                }
+                if (!collided[a])
+                {
+                    circles[a].bounce();
+                    collided[a] = 1;
+                }
+                if (haloFromBelow[h])
+                {
+                    circles[a].spawnParticles(particles);
+                }
+            }
+        }
+        for (size_t i = 0; i < circles.size(); i++)
+        {
+            circles[i].x += corrections[i].first;
+            circles[i].y += corrections[i].second;
+        }
+
+        for (const auto &pair : broadPhase.ownedPairs)
+        {
+            int a = pair.first;
+            int b = pair.second;
+            if ((collided[a] && collided[b]) || !circles[a].collide(circles[b]))
+            {
+                continue;
+            }
+
+            int burst = collided[a] ? b : a;
+            if (!collided[a])
+            {
+                circles[a].bounce();
+                collided[a] = 1;
+            }
+            if (!collided[b])
+            {
+                circles[b].bounce();
+                collided[b] = 1;
+            }
+            circles[burst].spawnParticles(particles);
+        }
+
+        for (auto &particle : particles)
+        {
+            int px = particle.x;
+            int py = particle.y;
+            if (py >= top && py < bottom && px >= 0 && px < canvasWidth)
+            {
+                shm.row(py)[px] = packColor({particle.color.r, particle.color.g, particle.color.b, 255});
+            }
+            particle.move();
+        }
+
+        // Eliminar las partículas muertas y enviar a los vecinos las que cruzaron el borde,
+        // para que las explosiones cerca del borde no queden cortadas
+        particlesUp.clear();
+        particlesDown.clear();
+        particles.erase(std::remove_if(particles.begin(), particles.end(), [&](const Particle &p)
+                                       {
+                                           if (p.lifetime <= 0)
+                                           {
+                                               return true;
+                                           }
+                                           if (strip > 0 && int(p.y) < top)
+                                           {
+                                               particlesUp.push_back(p);
+                                               return true;
+                                           }
+                                           if (strip < numStrips - 1 && int(p.y) >= bottom)
+                                           {
+                                               particlesDown.push_back(p);
+                                               return true;
+                                           }
+                                           return false; }),
+                        particles.end());
+        publish(shm.particleMailbox(strip, PARTICLES_UP), particlesUp, shm.particleCapacity);
+        publish(shm.particleMailbox(strip, PARTICLES_DOWN), particlesDown, shm.particleCapacity);
+
+        // Enviar a los vecinos los círculos cuyo centro salió de la franja
+        outUp.clear();
+        outDown.clear();
+        circles.erase(std::remove_if(circles.begin(), circles.end(), [&](const Circle &c)
+                                     {
+                                         if (strip > 0 && c.y < top)
+                                         {
+                                             outUp.push_back(c);
+                                             return true;
+                                         }
+                                         if (strip < numStrips - 1 && c.y >= bottom)
+                                         {
+                                             outDown.push_back(c);
+                                             return true;
+                                         }
+                                         return false; }),
+                      circles.end());
+        publish(shm.mailbox(strip, MIGRANTS_UP), outUp, shm.capacity);
+        publish(shm.mailbox(strip, MIGRANTS_DOWN), outDown, shm.capacity);
+
+        auto stop = std::chrono::high_resolution_clock::now();
+        totalTime += std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+        iterations++;
+
+        pthread_barrier_wait(&header->barrier);
+
+        // Fase 3: recibir los círculos y partículas que migraron desde las franjas vecinas
+        if (strip > 0)
+        {
+            receive(circles, shm.mailbox(strip - 1, MIGRANTS_DOWN));
+            receive(particles, shm.particleMailbox(strip - 1, PARTICLES_DOWN));
+        }
+        if (strip < numStrips - 1)
+        {
+            receive(circles, shm.mailbox(strip + 1, MIGRANTS_UP));
+            receive(particles, shm.particleMailbox(strip + 1, PARTICLES_UP));
+        }
+    }
+
+    if (iterations > 0)
+    {
+        std::cout << "Franja " << strip << ": " << circles.size() << " círculos, tiempo promedio "
+                  << totalTime / iterations << " microsegundos" << std::endl;
+    }
+}
+
+// Leer un argumento entero de la línea de comando
+static bool parseNumber(const char *arg, const char *name, int &value)
+{
+    try
+    {
+        value = std::stoi(arg);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << name << " no es un número válido." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Leer un argumento entero positivo de la línea de comando
+static bool parsePositive(const char *arg, const char *name, int &value)
+{
+    if (!parseNumber(arg, name, value))
+    {
+        return false;
+    }
+    if (value <= 0)
+    {
+        std::cerr << "Error: " << name << " debe ser un número positivo." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Leer el radio: 0 o -1 dejan los radios aleatorios, para poder fijar franjas y lienzo sin forzar un único radio
+static bool parseRadius(const char *arg, int &value)
+{
+    if (!parseNumber(arg, "El radio", value))
+    {
+        return false;
+    }
+    if (value == 0 || value == -1)
+    {
+        value = -1;
+    }
+    else if (value < 0)
+    {
+        std::cerr << "Error: El radio debe ser positivo, o 0/-1 para radios aleatorios." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Estado que necesita el manejador de SIGCHLD del compositor
+static pid_t *workerPids = nullptr;
+static volatile sig_atomic_t numWorkers = 0;
+static volatile sig_atomic_t stopping = 0;
+
+// Si un trabajador muere mientras la simulación corre, los demás y el compositor quedarían
+// bloqueados para siempre en la barrera: se terminan todos y se sale con error.
+// SDL o sus bibliotecas pueden crear y esperar sus propios procesos auxiliares, así que solo se
+// consultan los pid de los trabajadores y nunca se recoge a otros hijos.
+static void onWorkerExit(int)
+{
+    if (stopping)
+    {
+        return;
+    }
+    bool workerDied = false;
+    for (int i = 0; i < numWorkers; i++)
+    {
+        int status = 0;
+        if (waitpid(workerPids[i], &status, WNOHANG) == workerPids[i])
+        {
+            workerDied = true;
+        }
+    }
+    if (!workerDied)
+    {
+        return;
+    }
+    const char message[] = "Error: un proceso trabajador terminó inesperadamente.\n";
+    ssize_t written = write(STDERR_FILENO, message, sizeof(message) - 1);
+    (void)written;
+    for (int i = 0; i < numWorkers; i++)
+    {
+        kill(workerPids[i], SIGKILL);
+    }
+    _exit(1);
+}
+
+// Detener y esperar a los trabajadores ya creados; devuelve false si alguno no terminó limpiamente
+static bool stopWorkers(int signal)
+{
+    stopping = 1;
+    bool clean = true;
+    for (int i = 0; i < numWorkers; i++)
+    {
+        if (signal != 0)
+        {
+            kill(workerPids[i], signal);
+        }
+        int status = 0;
+        if (waitpid(workerPids[i], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            clean = false;
+        }
+    }
+    numWorkers = 0;
+    return clean;
+}
+
+int main(int argc, char *argv[])
+{
+    int canvasWidth = 640;
+    int canvasHeight = 480;
+    int N = 100;
+    int specifiedRadius = -1;
+    int numStrips = sysconf(_SC_NPROCESSORS_ONLN);
+
+    // Escenario de carga opcional (--escenario, --semilla)
+    SceneConfig scene;
+    if (!parseSceneArgs(argc, argv, scene))
+        return 1;
+
+    // Procesar argumentos de línea de comando
+    if (argc > 1 && !parsePositive(argv[1], "N", N))
+        return 1;
+    if (argc > 2 && !parseRadius(argv[2], specifiedRadius))
+        return 1;
+    if (argc > 3 && !parsePositive(argv[3], "El número de franjas", numStrips))
+        return 1;
+    if (argc > 4 && !parsePositive(argv[4], "El ancho", canvasWidth))
+        return 1;
+    if (argc > 5 && !parsePositive(argv[5], "El alto", canvasHeight))
+        return 1;
+
+    // Cada franja debe ser más alta que el diámetro máximo para que el halo solo involucre a los vecinos inmediatos
+    int maxRadius = specifiedRadius != -1 ? specifiedRadius : sceneMaxRadius(scene, canvasWidth, canvasHeight);
+    int maxStrips = std::max(1, canvasHeight / (2 * maxRadius + 2));
+    if (numStrips > maxStrips)
+    {
+        std::cerr << "Aviso: se reducen las franjas de " << numStrips << " a " << maxStrips
+                  << " para que cada una supere el diámetro máximo." << std::endl;
+        numStrips = maxStrips;
+    }
+
+    // Generar todos los círculos antes de crear los procesos; cada trabajador hereda su copia
+    std::vector<Circle> circles(N);
+    if (scene.enabled())
+    {
+        generateScene(circles.data(), N, canvasWidth, canvasHeight, scene);
+    }
+    for (int i = 0; i < N; i++)
+    {
+        if (!scene.enabled())
+        {
+            circles[i] = Circle::randomCircle(canvasWidth, canvasHeight);
+        }
+        if (specifiedRadius != -1)
+        {
+            circles[i].radius = specifiedRadius;
+        }
+        circles[i].id = i;
+    }
+
+    // En el peor caso todos los círculos terminan en una misma franja, por eso la capacidad es N.
+    // Las partículas son decorativas: si en un fotograma cruzan más que la capacidad, las sobrantes se pierden.
+    int particleCapacity = std::min(30 * N, 1 << 20);
+    SharedMemory shm(numStrips, N, particleCapacity, canvasWidth, canvasHeight);
+    if (!shm.create())
+    {
+        std::cerr << "Error: no se pudo crear la memoria compartida: " << strerror(errno) << std::endl;
+        return 1;
+    }
+
+    // Barrera compartida entre procesos: los trabajadores más el compositor
+    pthread_barrierattr_t attr;
+    pthread_barrierattr_init(&attr);
+    pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    int error = pthread_barrier_init(&shm.header()->barrier, &attr, numStrips + 1);
+    pthread_barrierattr_destroy(&attr);
+    if (error != 0)
+    {
+        std::cerr << "Error: no se pudo crear la barrera compartida: " << strerror(error) << std::endl;
+        shm.destroy();
+        return 1;
+    }
+    shm.header()->running = 1;
+
+    // Vigilar a los trabajadores: si uno muere, la barrera nunca se completaría
+    std::vector<pid_t> workers(numStrips);
+    workerPids = workers.data();
+    struct sigaction action = {};
+    action.sa_handler = onWorkerExit;
+    action.sa_flags = SA_NOCLDSTOP | SA_RESTART;
+    sigaction(SIGCHLD, &action, nullptr);
+
+    pid_t compositor = getpid();
+    for (int s = 0; s < numStrips; s++)
+    {
+        int top = s * canvasHeight / numStrips;
+        int bottom = (s + 1) * canvasHeight / numStrips;
+
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            std::cerr << "Error: no se pudo crear el proceso de la franja " << s << std::endl;
+            // Los trabajadores ya creados esperan en la barrera a un grupo que nunca se completará
+            shm.header()->running = 0;
+            stopWorkers(SIGKILL);
+            pthread_barrier_destroy(&shm.header()->barrier);
+            shm.destroy();
+            return 1;
+        }
+        if (pid == 0)
+        {
+            // Morir junto con el compositor en lugar de quedar bloqueado en la barrera
+            signal(SIGCHLD, SIG_DFL);
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+            if (getppid() != compositor)
+            {
+                _exit(1);
+            }
+
+            // Cada trabajador conserva solo los círculos cuyo centro cae en su franja
+            std::vector<Circle> owned;
+            for (const Circle &circle : circles)
+            {
+                int y = std::min(std::max(int(circle.y), 0), canvasHeight - 1);
+                if (y >= top && y < bottom)
+                {
+                    owned.push_back(circle);
+                }
+            }
+            circles.clear();
+            circles.shrink_to_fit();
+
+            // Con un escenario la semilla también fija las partículas de cada franja
+            srand(scene.enabled() ? scene.seed + s : time(nullptr) + s);
+            runWorker(shm, s, numStrips, top, bottom, canvasWidth, canvasHeight, maxRadius, std::move(owned));
+            _exit(0);
+        }
+        workers[s] = pid;
+        numWorkers = s + 1;
+    }
+    circles.clear();
+    circles.shrink_to_fit();
+
+    // El compositor inicializa SDL después de fork() para que los trabajadores no hereden su estado
+    SDL_Init(SDL_INIT_VIDEO);
+    SDL_Window *window = SDL_CreateWindow("Screensaver", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, canvasWidth, canvasHeight, SDL_WINDOW_SHOWN);
+    SDL_Renderer *renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    SDL_Texture *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, canvasWidth, canvasHeight);
+
+    Uint32 startTime = SDL_GetTicks();
+    Uint32 frameCount = 0;
+
+    while (true)
+    {
+        SDL_Event event;
+        while (SDL_PollEvent(&event))
+        {
+            if (event.type == SDL_QUIT)
+            {
+                stopping = 1;
+                shm.header()->running = 0;
+            }
+        }
+
+        // Los trabajadores leen `running` tras esta barrera, así todos ven el mismo valor
+        pthread_barrier_wait(&shm.header()->barrier);
+        if (!shm.header()->running)
+        {
+            break;
+        }
+
+        // Tras la segunda barrera el framebuffer está completo y nadie lo escribe hasta la siguiente fase 2
+        pthread_barrier_wait(&shm.header()->barrier);
+
+        SDL_UpdateTexture(texture, nullptr, shm.row(0), canvasWidth * sizeof(Uint32));
+        SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+        SDL_RenderPresent(renderer);
+
+        frameCount++;
+
+        if (SDL_GetTicks() - startTime >= 1000)
+        {
+            std::cout << "FPS: " << frameCount << std::endl;
+            frameCount = 0;
+            startTime += 1000;
+        }
+    }
+
+    bool clean = stopWorkers(0);
+    pthread_barrier_destroy(&shm.header()->barrier);
+    shm.destroy();
+    if (!clean)
+    {
+        std::cerr << "Error: algún proceso trabajador no terminó correctamente." << std::endl;
+    }
+
+    // Limpieza
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+
+    return clean ? 0 : 1;
+}
@@ -4,6 +4,7 @@
 #include <string>
 #include <iostream>
 #include <chrono>
+#include "Escenarios.h"
 
 struct Circle
 {
@@ -70,6 +71,10 @@ int main(int argc, char *argv[])
     int N = 100;    // Default number of circles
     int radius = 5; // Default radius
 
+    SceneConfig scene; // Optional stress scene (--escenario, --semilla)
+    if (!parseSceneArgs(argc, argv, scene))
+        return 1;
+
     if (argc > 1)
         N = std::stoi(argv[1]); // Number of circles from the first argument
     if (argc > 2)
@@ -79,9 +84,20 @@ int main(int argc, char *argv[])
     SDL_Renderer *renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
 
     Circle circles[N]; // Dynamically adjust based on N
-    for (int i = 0; i < N; i++)
+    if (scene.enabled())
+    {
+        generateScene(circles, N, canvasWidth, canvasHeight, scene);
+        for (int i = 0; argc > 2 && i < N; i++)
+        {
+            circles[i].radius = radius; // Explicit radius overrides the scene's radii
+        }
+    }
+    else
     {
-        circles[i] = Circle::randomCircle(canvasWidth, canvasHeight, radius);
+        for (int i = 0; i < N; i++)
+        {
+            circles[i] = Circle::randomCircle(canvasWidth, canvasHeight, radius);
+        }
     }
 
     bool isRunning = true;
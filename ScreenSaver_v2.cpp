@@ -6,6 +6,8 @@
 #include <iostream>
 #include <algorithm>
 #include <chrono>
+#include <utility>
+#include "Escenarios.h"
 
 // Clase Timer para medir el tiempo
 class Timer
@@ -53,7 +55,7 @@ struct Circle
     SDL_Color color;
 
     // Método para mover un círculo dentro de un área definida (canvas)
-    void move(int canvasWidth, int canvasHeight, std::vector<Circle> &circles, std::vector<Particle> &particles)
+    void move(int canvasWidth, int canvasHeight)
     {
         // Actualizar la posición del círculo según su velocidad (dx, dy)
         x += dx;
@@ -70,50 +72,58 @@ struct Circle
         {
             dy = -dy;
         }
+    }
+
+    // Prueba fina de colisión contra un par candidato del sweep-and-prune.
+    // Si los círculos se solapan, los separa hasta que solo se toquen y devuelve true.
+    bool collide(Circle &other)
+    {
+        // Calcular la distancia entre los centros de los dos círculos
+        float distance = sqrt(pow(x - other.x, 2) + pow(y - other.y, 2));
 
-        // Verificar si este círculo ha colisionado con otros círculos
-        for (auto &other : circles)
+        // Verificar si hay colisión
+        if (distance > (radius + other.radius))
         {
-            // Calcular la distancia entre los centros de los dos círculos
-            float distance = sqrt(pow(x - other.x, 2) + pow(y - other.y, 2));
+            return false;
+        }
 
-            // Verificar si hay colisión y que no sea el mismo círculo
-            if (&other != this && distance <= (radius + other.radius))
-            {
-                // Revertir la dirección de movimiento de este círculo
-                dx = -dx;
-                dy = -dy;
+        // Calcular la cantidad de superposición entre los dos círculos
+        float overlap = radius + other.radius - distance;
 
-                // Calcular la cantidad de superposición entre los dos círculos
-                float overlap = radius + other.radius - distance;
+        // Calcular el ángulo entre los dos círculos
+        float angle = atan2(y - other.y, x - other.x);
 
-                // Calcular el ángulo entre los dos círculos
-                float angle = atan2(y - other.y, x - other.x);
+        // Corregir la posición de ambos círculos para resolver la colisión
+        x += overlap * cos(angle) / 2;
+        y += overlap * sin(angle) / 2;
+        other.x -= overlap * cos(angle) / 2;
+        other.y -= overlap * sin(angle) / 2;
 
-                // Corregir la posición de ambos círculos para resolver la colisión
-                x += overlap * cos(angle) / 2;
-                y += overlap * sin(angle) / 2;
-                other.x -= overlap * cos(angle) / 2;
-                other.y -= overlap * sin(angle) / 2;
+        return true;
+    }
 
-                // Crear partículas cuando los círculos colisionan
-                const int numParticles = 30;
-                for (int i = 0; i < numParticles; i++)
-                {
-                    Particle p;
-                    p.x = x;
-                    p.y = y;
-                    float angle = (2 * M_PI / numParticles) * i;
-                    p.dx = 0.5 * cos(angle);
-                    p.dy = 0.5 * sin(angle);
-                    p.lifetime = 30 + (rand() % 20); // Vida aleatoria entre 30 y 49
-                    p.color = {Uint8(rand() % 256), Uint8(rand() % 256), Uint8(rand() % 256), 255};
-                    particles.push_back(p);
-                }
+    // Revertir la dirección de movimiento del círculo
+    void bounce()
+    {
+        dx = -dx;
+        dy = -dy;
+    }
 
-                // Romper el bucle; no es necesario verificar más colisiones para este círculo en este fotograma
-                break;
-            }
+    // Crear partículas en la posición del círculo cuando colisiona
+    void spawnParticles(std::vector<Particle> &particles) const
+    {
+        const int numParticles = 30;
+        for (int i = 0; i < numParticles; i++)
+        {
+            Particle p;
+            p.x = x;
+            p.y = y;
+            float angle = (2 * M_PI / numParticles) * i;
+            p.dx = 0.5 * cos(angle);
+            p.dy = 0.5 * sin(angle);
+            p.lifetime = 30 + (rand() % 20); // Vida aleatoria entre 30 y 49
+            p.color = {Uint8(rand() % 256), Uint8(rand() % 256), Uint8(rand() % 256), 255};
+            particles.push_back(p);
         }
     }
 
@@ -149,6 +159,82 @@ struct Circle
     }
 };
 
+// Fase amplia de colisiones sweep-and-prune.
+// Mantiene los círculos ordenados por el extremo izquierdo de su intervalo en x (x - radio).
+// Como los círculos se mueven como mucho ~1 píxel por fotograma, el orden casi no cambia entre
+// fotogramas y una ordenación por inserción sobre el orden anterior es prácticamente O(N).
+class SweepAndPrune
+{
+public:
+    // Reordenar los intervalos y devolver los pares candidatos cuyos intervalos se solapan en x e y
+    const std::vector<std::pair<int, int>> &update(const std::vector<Circle> &circles)
+    {
+        // Reconstruir el orden solo si cambió el número de círculos.
+        // El orden inicial es aleatorio, así que se ordena una vez con std::sort en lugar de por inserción.
+        if (entries.size() != circles.size())
+        {
+            entries.resize(circles.size());
+            for (size_t i = 0; i < entries.size(); i++)
+            {
+                const Circle &c = circles[i];
+                entries[i] = {c.x - c.radius, int(i)};
+            }
+            std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+                      { return a.minX < b.minX; });
+        }
+        else
+        {
+            // Refrescar el extremo izquierdo de cada intervalo con la posición actual
+            for (auto &entry : entries)
+            {
+                const Circle &c = circles[entry.index];
+                entry.minX = c.x - c.radius;
+            }
+
+            // Ordenación por inserción: casi lineal cuando el orden del fotograma anterior sigue siendo válido
+            for (size_t i = 1; i < entries.size(); i++)
+            {
+                Entry key = entries[i];
+                size_t j = i;
+                while (j > 0 && entries[j - 1].minX > key.minX)
+                {
+                    entries[j] = entries[j - 1];
+                    j--;
+                }
+                entries[j] = key;
+            }
+        }
+
+        // Barrido: cada intervalo solo se compara con los que empiezan antes de que él termine.
+        // El costo depende de los solapamientos reales, no del radio máximo, así que los radios mixtos no penalizan.
+        pairs.clear();
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            const Circle &a = circles[entries[i].index];
+            float maxX = a.x + a.radius;
+            for (size_t j = i + 1; j < entries.size() && entries[j].minX <= maxX; j++)
+            {
+                const Circle &b = circles[entries[j].index];
+                if (std::abs(a.y - b.y) <= a.radius + b.radius)
+                {
+                    pairs.emplace_back(entries[i].index, entries[j].index);
+                }
+            }
+        }
+        return pairs;
+    }
+
+private:
+    struct Entry
+    {
+        float minX;
+        int index;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<std::pair<int, int>> pairs;
+};
+
 int main(int argc, char *argv[])
 {
     // Inicializar SDL para el vídeo
@@ -162,6 +248,13 @@ int main(int argc, char *argv[])
     int N = 100;
     int specifiedRadius = -1;
 
+    // Extraer el escenario de carga opcional (--escenario, --semilla) antes de los argumentos posicionales
+    SceneConfig scene;
+    if (!parseSceneArgs(argc, argv, scene))
+    {
+        return 1;
+    }
+
     // Leer argumentos de línea de comandos, si los hay
     if (argc > 1)
     {
@@ -180,10 +273,21 @@ int main(int argc, char *argv[])
     std::vector<Circle> circles(N);
     std::vector<Particle> particles;
 
-    // Llenar el vector de círculos con círculos aleatorios
+    // Motor de colisiones y marcas de los círculos que ya resolvieron una colisión en el fotograma
+    SweepAndPrune broadPhase;
+    std::vector<char> collided(N);
+
+    // Llenar el vector de círculos con el escenario pedido o con círculos aleatorios
+    if (scene.enabled())
+    {
+        generateScene(circles.data(), N, canvasWidth, canvasHeight, scene);
+    }
     for (int i = 0; i < N; i++)
     {
-        circles[i] = Circle::randomCircle(canvasWidth, canvasHeight);
+        if (!scene.enabled())
+        {
+            circles[i] = Circle::randomCircle(canvasWidth, canvasHeight);
+        }
         if (specifiedRadius != -1)
         {
             circles[i].radius = specifiedRadius;
@@ -242,8 +346,43 @@ int main(int argc, char *argv[])
                         }
                     }
                 }
-                // Mover el círculo y manejar cualquier colisión.
-                circle.move(canvasWidth, canvasHeight, circles, particles);
+                // Mover el círculo y rebotar en los bordes.
+                circle.move(canvasWidth, canvasHeight);
+            }
+
+            // Resolver las colisiones solo entre los pares candidatos de la fase amplia.
+            // Cada círculo rebota como mucho una vez por fotograma.
+            std::fill(collided.begin(), collided.end(), 0);
+            for (const auto &pair : broadPhase.update(circles))
+            {
+                int a = pair.first;
+                int b = pair.second;
+
+                // Si ambos círculos ya rebotaron en este fotograma no hace falta la prueba fina
+                if (collided[a] && collided[b])
+                {
+                    continue;
+                }
+
+                // Una sola prueba fina por par: después de corregirlas, las posiciones quedan justo tocándose
+                if (!circles[a].collide(circles[b]))
+                {
+                    continue;
+                }
+
+                // Rebotar los círculos del par que aún no rebotaron y crear una sola explosión de partículas
+                int burst = collided[a] ? b : a;
+                if (!collided[a])
+                {
+                    circles[a].bounce();
+                    collided[a] = 1;
+                }
+                if (!collided[b])
+                {
+                    circles[b].bounce();
+                    collided[b] = 1;
+                }
+                circles[burst].spawnParticles(particles);
             }
 
             // Tomar el tiempo actual nuevamente para calcular la duración del proceso.
@@ -5,6 +5,8 @@
 #include <iostream>
 #include <algorithm>
 #include <chrono>
+#include <utility>
+#include "Escenarios.h"
 #include <omp.h>
 
 // Definición de clase Timer para medir el tiempo
@@ -49,8 +51,8 @@ struct Circle
     int radius;
     SDL_Color color;
 
-    // Método para mover el círculo y gestionar colisiones
-    void move(int canvasWidth, int canvasHeight, std::vector<Circle> &circles, std::vector<Particle> &particles)
+    // Método para mover el círculo y rebotar en los bordes
+    void move(int canvasWidth, int canvasHeight)
     {
         x += dx;
         y += dy;
@@ -63,38 +65,50 @@ struct Circle
         {
             dy = -dy;
         }
-        for (auto &other : circles)
+    }
+
+    // Prueba fina de colisión para un par candidato; si hay colisión separa los círculos y devuelve true
+    bool collide(Circle &other)
+    {
+        float distance = sqrt(pow(x - other.x, 2) + pow(y - other.y, 2));
+        if (distance > (radius + other.radius))
         {
-            float distance = sqrt(pow(x - other.x, 2) + pow(y - other.y, 2));
-            if (&other != this && distance <= (radius + other.radius))
-            {
-                dx = -dx;
-                dy = -dy;
-
-                // Mover los círculos fuera del área de colisión
-                float overlap = radius + other.radius - distance;
-                float angle = atan2(y - other.y, x - other.x);
-                x += overlap * cos(angle) / 2;
-                y += overlap * sin(angle) / 2;
-                other.x -= overlap * cos(angle) / 2;
-                other.y -= overlap * sin(angle) / 2;
-
-                const int numParticles = 30;
-                for (int i = 0; i < numParticles; i++)
-                {
-                    Particle p;
-                    p.x = x;
-                    p.y = y;
-                    float angle = (2 * M_PI / numParticles) * i;
-                    p.dx = 0.5 * cos(angle);
-                    p.dy = 0.5 * sin(angle);
-                    p.lifetime = 30 + (rand() % 20);
-                    p.color = {Uint8(rand() % 256), Uint8(rand() % 256), Uint8(rand() % 256), 255};
-                    particles.push_back(p);
-                }
+            return false;
+        }
 
-                break;
-            }
+        // Mover los círculos fuera del área de colisión
+        float overlap = radius + other.radius - distance;
+        float angle = atan2(y - other.y, x - other.x);
+        x += overlap * cos(angle) / 2;
+        y += overlap * sin(angle) / 2;
+        other.x -= overlap * cos(angle) / 2;
+        other.y -= overlap * sin(angle) / 2;
+
+        return true;
+    }
+
+    // Método para revertir la dirección del círculo
+    void bounce()
+    {
+        dx = -dx;
+        dy = -dy;
+    }
+
+    // Método para crear partículas en la posición del círculo
+    void spawnParticles(std::vector<Particle> &particles) const
+    {
+        const int numParticles = 30;
+        for (int i = 0; i < numParticles; i++)
+        {
+            Particle p;
+            p.x = x;
+            p.y = y;
+            float angle = (2 * M_PI / numParticles) * i;
+            p.dx = 0.5 * cos(angle);
+            p.dy = 0.5 * sin(angle);
+            p.lifetime = 30 + (rand() % 20);
+            p.color = {Uint8(rand() % 256), Uint8(rand() % 256), Uint8(rand() % 256), 255};
+            particles.push_back(p);
         }
     }
     // Método estático para generar un círculo aleatorio
@@ -111,6 +125,77 @@ struct Circle
     }
 };
 
+// Fase amplia sweep-and-prune: intervalos en x (x ± radio) ordenados por inserción.
+// Los círculos se mueven ~1 píxel por fotograma, así que el orden anterior casi siempre sigue
+// siendo válido y reordenar es prácticamente O(N).
+class SweepAndPrune
+{
+public:
+    // Devuelve los pares candidatos cuyos intervalos se solapan en x e y
+    const std::vector<std::pair<int, int>> &update(const std::vector<Circle> &circles)
+    {
+        // Al reconstruir, el orden es aleatorio: std::sort una vez en lugar de inserción O(N²)
+        if (entries.size() != circles.size())
+        {
+            entries.resize(circles.size());
+            for (size_t i = 0; i < entries.size(); i++)
+            {
+                const Circle &c = circles[i];
+                entries[i] = {c.x - c.radius, int(i)};
+            }
+            std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+                      { return a.minX < b.minX; });
+        }
+        else
+        {
+            for (auto &entry : entries)
+            {
+                const Circle &c = circles[entry.index];
+                entry.minX = c.x - c.radius;
+            }
+
+            // La ordenación por inserción es secuencial; no se paraleliza con OpenMP
+            for (size_t i = 1; i < entries.size(); i++)
+            {
+                Entry key = entries[i];
+                size_t j = i;
+                while (j > 0 && entries[j - 1].minX > key.minX)
+                {
+                    entries[j] = entries[j - 1];
+                    j--;
+                }
+                entries[j] = key;
+            }
+        }
+
+        pairs.clear();
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            const Circle &a = circles[entries[i].index];
+            float maxX = a.x + a.radius;
+            for (size_t j = i + 1; j < entries.size() && entries[j].minX <= maxX; j++)
+            {
+                const Circle &b = circles[entries[j].index];
+                if (std::abs(a.y - b.y) <= a.radius + b.radius)
+                {
+                    pairs.emplace_back(entries[i].index, entries[j].index);
+                }
+            }
+        }
+        return pairs;
+    }
+
+private:
+    struct Entry
+    {
+        float minX;
+        int index;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<std::pair<int, int>> pairs;
+};
+
 int main(int argc, char *argv[])
 {
     // Inicializar SDL para vídeo
@@ -122,6 +207,13 @@ int main(int argc, char *argv[])
     int specifiedRadius = -1;
 
 
+    // Escenario de carga opcional (--escenario, --semilla)
+    SceneConfig scene;
+    if (!parseSceneArgs(argc, argv, scene))
+    {
+        return 1;
+    }
+
     // Procesar argumentos de línea de comando
     if (argc > 1)
     {
@@ -165,20 +257,36 @@ int main(int argc, char *argv[])
     std::vector<Circle> circles(N);
     std::vector<Particle> particles;
 
-// Inicializar círculos con OpenMP
-#pragma omp parallel for
-    for (int i = 0; i < N; i++)
-    {
-        Circle circulo = Circle::randomCircle(canvasWidth, canvasHeight);
+    // Fase amplia de colisiones y marcas de círculos que ya colisionaron en el fotograma
+    SweepAndPrune broadPhase;
+    std::vector<char> collided(N);
 
-        if (specifiedRadius != -1)
+    // El escenario se genera en serie para que sea reproducible con la semilla
+    if (scene.enabled())
+    {
+        generateScene(circles.data(), N, canvasWidth, canvasHeight, scene);
+        for (int i = 0; specifiedRadius != -1 && i < N; i++)
         {
-            circulo.radius = specifiedRadius;
+            circles[i].radius = specifiedRadius;
         }
+    }
+    else
+    {
+// Inicializar círculos con OpenMP
+#pragma omp parallel for
+        for (int i = 0; i < N; i++)
+        {
+            Circle circulo = Circle::randomCircle(canvasWidth, canvasHeight);
+
+            if (specifiedRadius != -1)
+            {
+                circulo.radius = specifiedRadius;
+            }
 
 #pragma omp critical
-        {
-            circles[i] = circulo;
+            {
+                circles[i] = circulo;
+            }
         }
     }
     // Variables para el control del bucle principal
@@ -230,7 +338,32 @@ int main(int argc, char *argv[])
                         }
                     }
                 }
-                circle.move(canvasWidth, canvasHeight, circles, particles);
+                circle.move(canvasWidth, canvasHeight);
+            }
+
+            // Una sola prueba fina por par candidato; cada círculo rebota como mucho una vez por fotograma
+            std::fill(collided.begin(), collided.end(), 0);
+            for (const auto &pair : broadPhase.update(circles))
+            {
+                int a = pair.first;
+                int b = pair.second;
+                if ((collided[a] && collided[b]) || !circles[a].collide(circles[b]))
+                {
+                    continue;
+                }
+
+                int burst = collided[a] ? b : a;
+                if (!collided[a])
+                {
+                    circles[a].bounce();
+                    collided[a] = 1;
+                }
+                if (!collided[b])
+                {
+                    circles[b].bounce();
+                    collided[b] = 1;
+                }
+                circles[burst].spawnParticles(particles);
             }
             auto stopCircles = std::chrono::high_resolution_clock::now();
             auto durationCircles = std::chrono::duration_cast<std::chrono::microseconds>(stopCircles - startCircles);